@@ -0,0 +1,236 @@
+/**
+ * @file TTFContext.h
+ * Contains the TTFContext class.
+ *
+ * Copyright (C) 2011 Thomas P. Lahoda
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef SDL_SUBSYSTEM_TTFCONTEXT_H
+#define SDL_SUBSYSTEM_TTFCONTEXT_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include <SDL_ttf.h>
+
+#if SDL_TTF_MAJOR_VERSION < 2 || (SDL_TTF_MAJOR_VERSION == 2 && SDL_TTF_MINOR_VERSION == 0 && SDL_TTF_PATCHLEVEL < 10)
+#error "TTFContext requires SDL_ttf 2.0.10 or later, where TTF_Init and TTF_Quit are reference counted"
+#endif
+
+namespace sdl {
+namespace subsystem {
+    using namespace std;
+
+    /**
+     * @struct TTFContext
+     * @brief An explicitly owned, lazily opened reference to the TTF library.
+     *
+     * Each context holds one TTF_Init reference from the time it is opened
+     * until it is closed or destroyed, so contexts may be created and
+     * destroyed independently, e.g. one per thread. This relies on TTF_Init
+     * and TTF_Quit being reference counted, which SDL_ttf does from 2.0.10;
+     * older versions are rejected at compile time. Fonts opened through a
+     * context keep it alive. SDL_ttf shares one FreeType library between
+     * contexts, so opening and closing fonts through contexts is serialized.
+     */
+    struct TTFContext : enable_shared_from_this<TTFContext> {
+        /**
+         * @typedef chrono::steady_clock::duration Duration
+         * @brief The type of the measured open and close times.
+         */
+        typedef chrono::steady_clock::duration Duration;
+
+        /**
+         * Creates an unopened TTFContext.
+         *
+         * @return The TTFContext.
+         */
+        static shared_ptr<TTFContext> create () { return shared_ptr<TTFContext> (new TTFContext ()); };
+
+        /**
+         * Returns the process wide TTFContext, used by Fonts opened without
+         * an explicit context and by FontManager::instance.
+         *
+         * @return The process wide TTFContext.
+         */
+        static const shared_ptr<TTFContext>& shared () {
+            static shared_ptr<TTFContext> shared_ (create ());
+            return shared_;
+        };
+
+        /**
+         * Closes the TTFContext. This TTF_Quit is not measured; call close
+         * beforehand to measure teardown.
+         */
+        ~TTFContext () {
+            lock_guard<mutex> lock (library ());
+            if (open_)
+                TTF_Quit ();
+        };
+
+        /**
+         * Opens the TTFContext if it is not already open.
+         */
+        void open () {
+            lock_guard<mutex> lock (library ());
+            openLocked ();
+        };
+
+        /**
+         * Closes the TTFContext if it is open, measuring the TTF_Quit. It may
+         * be opened again later. Every font opened through the TTFContext
+         * must have been closed first, e.g. by FontManager::clear.
+         */
+        void close () {
+            lock_guard<mutex> lock (library ());
+            if (!open_)
+                return;
+            if (fonts_ != 0)
+                throw logic_error ("TTFContext closed with fonts still open");
+            chrono::steady_clock::time_point start = chrono::steady_clock::now ();
+            TTF_Quit ();
+            closeDuration_ = chrono::steady_clock::now () - start;
+            open_ = false;
+        };
+
+        /**
+         * Determines if the TTFContext is open.
+         *
+         * @return True if the TTFContext is open, false otherwise.
+         */
+        bool isOpen () const {
+            lock_guard<mutex> lock (library ());
+            return open_;
+        };
+
+        /**
+         * Returns the time taken by the last open of the TTFContext.
+         *
+         * @return The open time, zero if the TTFContext was never opened.
+         */
+        Duration openDuration () const {
+            lock_guard<mutex> lock (library ());
+            return openDuration_;
+        };
+
+        /**
+         * Returns the time taken by the last close of the TTFContext.
+         *
+         * @return The close time, zero if the TTFContext was never closed.
+         */
+        Duration closeDuration () const {
+            lock_guard<mutex> lock (library ());
+            return closeDuration_;
+        };
+
+        /**
+         * Opens a font, with the given point size, from a file, opening the
+         * TTFContext first if needed. The font keeps the TTFContext alive.
+         *
+         * @param filename The font file.
+         * @param pointSize The point size.
+         *
+         * @return The TTF_Font structure.
+         */
+        shared_ptr<TTF_Font> openFont (const string& filename, int pointSize) {
+            lock_guard<mutex> lock (library ());
+            openLocked ();
+            TTF_Font* font = TTF_OpenFont (filename.c_str (), pointSize);
+            if (font == NULL)
+                throw runtime_error (TTF_GetError ());
+            ++fonts_;
+            shared_ptr<TTFContext> self = shared_from_this ();
+            return shared_ptr<TTF_Font> (font, [self] (TTF_Font* f) {
+                lock_guard<mutex> lock (library ());
+                TTF_CloseFont (f);
+                --self->fonts_;
+            });
+        };
+
+        private:
+            /**
+             * Constructs an unopened TTFContext. The library mutex is created
+             * here so that it outlives every static owner of a TTFContext.
+             */
+            TTFContext () : open_ (false), fonts_ (0), openDuration_ (), closeDuration_ () { library (); };
+
+            /**
+             * Copy constructs a TTFContext.
+             *
+             * @param rhs The TTFContext to copy.
+             */
+            TTFContext (const TTFContext& rhs);
+
+            /**
+             * The assignment operator.
+             *
+             * @param rhs The TTFContext from which to assign.
+             *
+             * @return A reference to this TTFContext.
+             */
+            TTFContext& operator= (const TTFContext& rhs);
+
+            /**
+             * Opens the TTFContext if it is not already open. The library
+             * mutex must be held.
+             */
+            void openLocked () {
+                if (open_)
+                    return;
+                chrono::steady_clock::time_point start = chrono::steady_clock::now ();
+                if (TTF_Init () == -1)
+                    throw runtime_error (TTF_GetError ());
+                openDuration_ = chrono::steady_clock::now () - start;
+                open_ = true;
+            };
+
+            /**
+             * Returns the mutex guarding the shared TTF library.
+             *
+             * @return The mutex.
+             */
+            static mutex& library () {
+                static mutex library_;
+                return library_;
+            };
+
+            /**
+             * Whether this TTFContext holds a TTF_Init reference.
+             */
+            bool open_;
+
+            /**
+             * The number of fonts open through this TTFContext.
+             */
+            size_t fonts_;
+
+            /**
+             * The time taken by the last TTF_Init.
+             */
+            Duration openDuration_;
+
+            /**
+             * The time taken by the last TTF_Quit.
+             */
+            Duration closeDuration_;
+    }; //TTFContext
+}; //subsystem
+}; //sdl
+
+#endif //SDL_SUBSYSTEM_TTFCONTEXT_H
@@ -21,10 +21,12 @@
 #ifndef SDL_TTF_H
 #define SDL_TTF_H
 
+#include <memory>
 #include <stdexcept>
 
 #include <SDL_ttf.h>
 
+#include "sdlpp_ttf/subsystem/TTFContext.h"
 #include "sdlpp_ttf/ttf/Glyph.h"
 #include "sdlpp/video/Surface.h"
 
@@ -45,18 +47,22 @@ namespace ttf {
      */
     struct Font {
         /**
-         * Constructs a font, with the given point size, from a file.
+         * Constructs a font, with the given point size, from a file, opened
+         * through the process wide TTFContext.
          */
         Font (const string& filename, int pointSize) 
-          : font_ (TTF_OpenFont (filename.c_str (), pointSize), &TTF_CloseFont) {
-            if (font_.get () == NULL)
-                throw runtime_error (TTF_GetError ());
-        };
+          : font_ (subsystem::TTFContext::shared ()->openFont (filename, pointSize)) {};
 
         /**
-         * Destroys the Font.
+         * Constructs a font, with the given point size, from a file, opened
+         * through context. The Font keeps context alive.
+         *
+         * @param context The TTFContext to open the font through.
+         * @param filename The font file.
+         * @param pointSize The point size.
          */
-        ~Font () {};
+        Font (const shared_ptr<subsystem::TTFContext>& context, const string& filename, int pointSize)
+          : font_ (context->openFont (filename, pointSize)) {};
 
         /**
          * Returns a Surface containg the text rendered in the render mode.
@@ -137,10 +143,13 @@ namespace ttf {
          *
          * @return The style.
          */
-        int getStyle () { return TTF_GetFontStyle (font_.get ()); };
+        int getStyle () const { return TTF_GetFontStyle (font_.get ()); };
 
         /**
-         * Sets the fon't style.
+         * Sets the fon't style. The style belongs to the underlying TTF_Font,
+         * so it is shared by every copy of the Font. Caches built from the
+         * Font, such as a GlyphCache, and TextQueue requests not yet flushed
+         * see the new style.
          *
          * @param style The style.
          */
@@ -150,9 +159,57 @@ namespace ttf {
             /**
              * The TTF_Font structure.
              */
-            boost::shared_ptr<TTF_Font> font_;
+            shared_ptr<TTF_Font> font_;
     }; //Font
 
+    /**
+     * @struct FontRef
+     * @brief A non-owning view of a Font.
+     *
+     * Copying a FontRef does not touch the Font's reference count. The Font
+     * must outlive the FontRef.
+     */
+    struct FontRef {
+        /**
+         * Constructs a FontRef viewing font.
+         *
+         * @param font The Font to view.
+         */
+        FontRef (const Font& font) : font_ (&font) {};
+
+        /**
+         * A FontRef may not view a temporary Font.
+         */
+        FontRef (Font&&) = delete;
+
+        /**
+         * Returns the viewed Font.
+         *
+         * @return The Font.
+         */
+        operator const Font& () const { return *font_; };
+
+        /**
+         * Returns the viewed Font.
+         *
+         * @return The Font.
+         */
+        const Font& font () const { return *font_; };
+
+        /**
+         * Returns the underlying TTF_Font structure.
+         *
+         * @return The underlying TTF_Font structure.
+         */
+        TTF_Font* operator* () const { return **font_; };
+
+        private:
+            /**
+             * The viewed Font.
+             */
+            const Font* font_;
+    }; //FontRef
+
     //TEXT specialization
     template<>
     void Font::size<TEXT> (const string& text, int* height, int* width) const {
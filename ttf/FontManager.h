@@ -24,7 +24,7 @@
 #include <map>
 #include <string>
 
-#include "sdlpp_ttf/subsystem/TTF.h"
+#include "sdlpp_ttf/subsystem/TTFContext.h"
 #include "sdlpp_ttf/ttf/Font.h"
 
 namespace sdl {
@@ -34,6 +34,11 @@ namespace ttf {
     /**
      * @struct FontManager 
      * @brief Manages fonts.
+     *
+     * Each FontManager holds a TTFContext, opened when the first Font is
+     * requested unless it is opened earlier through context. FontManagers
+     * with separate contexts share no Fonts and may be used from separate
+     * threads.
      */
     struct FontManager {
         /**
@@ -42,46 +47,78 @@ namespace ttf {
          * @return A rerence to the FontManager.
          */
         static FontManager& instance () {
-            static FontManager instance_;
+            static FontManager instance_ (subsystem::TTFContext::shared ());
             return instance_;
         };
-    
+
+        /**
+         * Returns the calling thread's instance of the FontManager.
+         *
+         * @return A reference to the FontManager.
+         */
+        static FontManager& threadInstance () {
+            thread_local FontManager instance_;
+            return instance_;
+        };
+
+        /**
+         * Constructs a FontManager with its own, unopened, TTFContext.
+         */
+        FontManager () : context_ (subsystem::TTFContext::create ()), fonts_ () {};
+
+        /**
+         * Constructs a FontManager sharing context.
+         *
+         * @param context The TTFContext to open Fonts through.
+         */
+        FontManager (const shared_ptr<subsystem::TTFContext>& context) : context_ (context), fonts_ () {};
+
         //~FontManager ();
+
+        /**
+         * Returns the TTFContext of the FontManager, e.g. to open it ahead of
+         * the first Font.
+         *
+         * @return The TTFContext.
+         */
+        const shared_ptr<subsystem::TTFContext>& context () const { return context_; };
    
         /**
          * Returns the Font of the given name in the given point size.
          *
+         * The returned reference remains valid until clear or the FontManager
+         * is destroyed.
+         * The Font is shared by every caller, so it is read-only; to change its
+         * style, copy it, which shares the underlying TTF_Font, and set the style
+         * on the copy. The change is then seen by every user of the Font.
+         *
          * @param fileName The name of the Font to retrieve.
          * @param pointSize The point size.
          *
          * @return The Font.
          */
-        Font font (const string& fileName, int pointSize) {
+        const Font& font (const string& fileName, int pointSize) {
             FontMap::iterator nameIter = fonts_.find (fileName);
             if (nameIter != fonts_.end ()) {
                 FontSizeMap::iterator sizeIter = nameIter->second.find (pointSize);
-                if (sizeIter != nameIter->second.end ()) {
+                if (sizeIter != nameIter->second.end ())
                     return sizeIter->second;
-                } else {
-                    Font font (fileName, pointSize);
-                    nameIter->second.insert (make_pair (pointSize, font));
-                    return font;
-                }
-            } else {
-                Font font (fileName, pointSize);
-                FontSizeMap sizeMap;
-                sizeMap.insert (make_pair (pointSize, font));
-                fonts_.insert (make_pair (fileName, sizeMap));
-                return font;
             }
+
+            Font font (context_, fileName, pointSize);
+            if (nameIter == fonts_.end ())
+                nameIter = fonts_.emplace (fileName, FontSizeMap ()).first;
+            return nameIter->second.emplace (pointSize, move (font)).first->second;
         };
 
+        /**
+         * Releases every Font of the FontManager, invalidating references
+         * returned by font. Once no copies of the Fonts remain, the TTFContext
+         * may be closed.
+         */
+        void clear () { fonts_.clear (); };
+
         private:
-            /**
-             * Constructs a FontManager.
-             */
-            FontManager() : fonts_ () { subsystem::TTF::instance (); };
-           
             /**
              * Copy constructs a FontManager.
              *
@@ -110,6 +147,11 @@ namespace ttf {
              */
             typedef map<string, FontSizeMap> FontMap;
 
+            /**
+             * The TTFContext the Fonts are opened through.
+             */
+            shared_ptr<subsystem::TTFContext> context_;
+
             /**
              * The map of Fonts.
              */
@@ -0,0 +1,253 @@
+/**
+ * @file GlyphCache.h
+ * Contains the GlyphCache class.
+ *
+ * Copyright (C) 2011 Thomas P. Lahoda
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef SDL_TTF_GLYPHCACHE_H
+#define SDL_TTF_GLYPHCACHE_H
+
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+
+#include "sdlpp/video/Surface.h"
+#include "sdlpp_ttf/ttf/Font.h"
+#include "sdlpp_ttf/ttf/Glyph.h"
+#include "sdlpp_ttf/ttf/RenderModes.h"
+
+namespace sdl {
+namespace ttf {
+    using namespace std;
+    using namespace video;
+
+    /**
+     * @struct GlyphCache
+     * @brief Caches AlphaMask glyphs of a Font at horizontal sub-pixel offsets.
+     *
+     * Each glyph is rasterized once at a whole-pixel offset. The fractional
+     * variants are approximations resampled from that raster by linear
+     * interpolation, not separate rasterizations, so they are slightly softer
+     * than the whole-pixel mask. Text at a fractional pen position is drawn
+     * from these cached masks.
+     *
+     * Glyphs are placed by their advances alone, without kerning, since
+     * SDL_ttf exposes kerning only by FreeType glyph index. Strings drawn
+     * through the cache may therefore differ from Font::render of kerned fonts.
+     *
+     * The cache records the style of the Font it was filled with and discards
+     * its glyphs when the Font's style has since changed.
+     */
+    struct GlyphCache {
+        /**
+         * The number of horizontal sub-pixel variants kept for each glyph.
+         */
+        static const int SUBPIXELS = 4;
+
+        /**
+         * Constructs an empty GlyphCache of font.
+         *
+         * @param font The Font to cache.
+         */
+        GlyphCache (const Font& font) : font_ (font), style_ (font.getStyle ()), entries_ () {};
+
+        /**
+         * Returns the Glyph of c.
+         *
+         * @param c The character.
+         *
+         * @return The Glyph.
+         */
+        const Glyph& glyph (char c) { return entry (c).glyph; };
+
+        /**
+         * Returns the mask of c resampled right by subpixel / SUBPIXELS of a pixel.
+         *
+         * @param c The character.
+         * @param subpixel The offset, from 0 to SUBPIXELS - 1.
+         *
+         * @return The mask.
+         */
+        const Surface& mask (char c, int subpixel) {
+            if (subpixel < 0 || subpixel >= SUBPIXELS)
+                throw out_of_range ("GlyphCache sub-pixel offset out of range");
+            return entry (c).masks[subpixel];
+        };
+
+        /**
+         * Draws c at a fractional pen position.
+         *
+         * @param c The character to draw.
+         * @param x The pen position.
+         * @param y The top of the line in dst.
+         * @param color The Color of the glyph.
+         * @param dst The Surface to draw to.
+         *
+         * @return The pen position following c.
+         */
+        float draw (char c, float x, int y, SDL_Color color, Surface& dst) {
+            const Entry& e = entry (c);
+            int pixel = static_cast<int> (floor (x));
+            int subpixel = static_cast<int> ((x - pixel) * SUBPIXELS + 0.5f);
+            if (subpixel == SUBPIXELS) {
+                ++pixel;
+                subpixel = 0;
+            }
+            AlphaMask::blit (e.masks[subpixel], color, dst,
+                             pixel + e.glyph.minx (),
+                             y + font_.ascent () - e.glyph.maxy ());
+            return x + e.glyph.advance ();
+        };
+
+        /**
+         * Draws text at a fractional pen position, without kerning.
+         *
+         * @param text The string to draw.
+         * @param x The pen position.
+         * @param y The top of the line in dst.
+         * @param color The Color of the text.
+         * @param dst The Surface to draw to.
+         *
+         * @return The pen position following text.
+         */
+        float draw (const string& text, float x, int y, SDL_Color color, Surface& dst) {
+            for (string::const_iterator iter = text.begin (); iter != text.end (); ++iter)
+                x = draw (*iter, x, y, color, dst);
+            return x;
+        };
+
+        /**
+         * Discards every cached glyph.
+         */
+        void clear () { entries_.clear (); };
+
+        private:
+            /**
+             * @struct Entry
+             * @brief The Glyph and masks of a character.
+             */
+            struct Entry {
+                /**
+                 * Rasterizes c in font and builds its shifted masks.
+                 *
+                 * @param font The Font to use.
+                 * @param c The character.
+                 */
+                Entry (const Font& font, char c) : glyph (font, c), masks () {
+                    Surface base (AlphaMask ().render (font, c));
+                    if (*base == NULL)
+                        throw runtime_error (TTF_GetError ());
+                    masks.reserve (SUBPIXELS);
+                    for (int subpixel = 0; subpixel < SUBPIXELS; ++subpixel)
+                        masks.push_back (shift (*base, subpixel));
+                };
+
+                /**
+                 * The Glyph.
+                 */
+                Glyph glyph;
+
+                /**
+                 * The masks, indexed by sub-pixel offset.
+                 */
+                vector<Surface> masks;
+            }; //Entry
+
+            /**
+             * Returns the Entry of c, rasterizing it on first use or after the
+             * Font's style has changed.
+             *
+             * @param c The character.
+             *
+             * @return The Entry.
+             */
+            const Entry& entry (char c) {
+                int style = font_.getStyle ();
+                if (style != style_) {
+                    entries_.clear ();
+                    style_ = style;
+                }
+                EntryMap::iterator iter = entries_.find (c);
+                if (iter == entries_.end ())
+                    iter = entries_.insert (make_pair (c, Entry (font_, c))).first;
+                return iter->second;
+            };
+
+            /**
+             * Returns a copy of mask, one pixel wider, linearly resampled to
+             * approximate a shift right by subpixel / SUBPIXELS of a pixel.
+             *
+             * @param mask The 8-bit mask.
+             * @param subpixel The offset.
+             *
+             * @return The shifted mask.
+             */
+            static Surface shift (SDL_Surface* mask, int subpixel) {
+                SDL_Surface* out = SDL_CreateRGBSurface (SDL_SWSURFACE, mask->w + 1, mask->h, 8, 0, 0, 0, 0);
+                if (out == NULL)
+                    throw runtime_error (SDL_GetError ());
+                SDL_SetColors (out, mask->format->palette->colors, 0, mask->format->palette->ncolors);
+
+                if (SDL_MUSTLOCK (mask) && SDL_LockSurface (mask) == -1) {
+                    SDL_FreeSurface (out);
+                    throw runtime_error (SDL_GetError ());
+                }
+                for (int row = 0; row < mask->h; ++row) {
+                    const Uint8* in = static_cast<const Uint8*> (mask->pixels) + row * mask->pitch;
+                    Uint8* shifted = static_cast<Uint8*> (out->pixels) + row * out->pitch;
+                    for (int col = 0; col < out->w; ++col) {
+                        int current = col < mask->w ? in[col] : 0;
+                        int previous = col > 0 ? in[col - 1] : 0;
+                        shifted[col] = static_cast<Uint8> ((current * (SUBPIXELS - subpixel) + previous * subpixel + SUBPIXELS / 2) / SUBPIXELS);
+                    }
+                }
+                if (SDL_MUSTLOCK (mask))
+                    SDL_UnlockSurface (mask);
+
+                return Surface (out);
+            };
+
+            /**
+             * @typedef map<char, Entry> EntryMap
+             * @brief The type of the character to Entry map.
+             */
+            typedef map<char, Entry> EntryMap;
+
+            /**
+             * The cached Font.
+             */
+            Font font_;
+
+            /**
+             * The style of font_ the cached glyphs were rasterized with.
+             */
+            int style_;
+
+            /**
+             * The cached glyphs.
+             */
+            EntryMap entries_;
+    }; //GlyphCache
+}; //ttf
+}; //sdl
+
+#endif //SDL_TTF_GLYPHCACHE_H
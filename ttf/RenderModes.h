@@ -1,6 +1,6 @@
 /**
  * @file RenderModes.h
- * Contains the Solid, Shaded, and Blended render mode classes.
+ * Contains the Solid, Shaded, Blended, and AlphaMask render mode classes.
  *
  * Copyright (C) 2005 Thomas P. Lahoda
  *
@@ -21,6 +21,9 @@
 #ifndef SDL_TTF_RENDERMODES_H
 #define SDL_TTF_RENDERMODES_H
 
+#include <algorithm>
+
+#include <SDL.h>
 #include <SDL_ttf.h>
 
 #include "sdlpp/video/Surface.h"
@@ -43,7 +46,14 @@ namespace ttf {
          *
          * @param color The color mask for the Font.
          */
-        Solid (const Color& color) : color_ (color) {};
+        Solid (SDL_Color color) : color_ (color) {};
+
+        /**
+         * Constructs a Solid font renderer with the specified color mask.
+         *
+         * @param color The color mask for the Font.
+         */
+        Solid (const Color& color) : color_ (**color) {};
 
         /**
          * Returns a Surface containing c rendered in font.
@@ -54,7 +64,7 @@ namespace ttf {
          * @return The rendered Surface.
          */
         Surface render (const Font& font, char c) const {
-            return Surface (TTF_RenderGlyph_Solid (*font, c, **color_));
+            return Surface (TTF_RenderGlyph_Solid (*font, c, color_));
         };
 
         /**
@@ -69,31 +79,31 @@ namespace ttf {
          */
         template<int Encoding>
         Surface render (const Font& font, const string& text) const {
-            return Surface (TTF_RenderText_Solid (*font, text.c_str (), **color_));
+            return Surface (TTF_RenderText_Solid (*font, text.c_str (), color_));
         };
 
         private:
             /**
              * The Color to render the Font.
              */
-            Color color_;
+            SDL_Color color_;
     }; //Solid
 
     template<>
     Surface Solid::render<TEXT> (const Font& font, const string& text) const {
-        return Surface (TTF_RenderText_Solid (*font, text.c_str (), **color_));
+        return Surface (TTF_RenderText_Solid (*font, text.c_str (), color_));
     };
 
     //UTF8 specialization
     template<>
     Surface Solid::render<UTF8> (const Font& font, const string& text) const {
-        return Surface (TTF_RenderUTF8_Solid (*font, text.c_str (), **color_));
+        return Surface (TTF_RenderUTF8_Solid (*font, text.c_str (), color_));
     };
 
     //UNICODE specialization
     template<>
     Surface Solid::render<UNICODE> (const Font& font, const string& text) const {
-        return Surface ();//TTF_RenderUNICODE_Solid (*font, text.c_str (), **color_));
+        return Surface ();//TTF_RenderUNICODE_Solid (*font, text.c_str (), color_));
     };
 
     /**
@@ -107,7 +117,15 @@ namespace ttf {
          * @param fg The foreground Color.
          * @param bg The background Color.
          */
-        Shaded (const Color& fg, const Color& bg) : fg_ (fg), bg_ (bg) {};
+        Shaded (SDL_Color fg, SDL_Color bg) : fg_ (fg), bg_ (bg) {};
+
+        /**
+         * Constructs a Shaded font renderer with the specified foreground and background colors. 
+         *
+         * @param fg The foreground Color.
+         * @param bg The background Color.
+         */
+        Shaded (const Color& fg, const Color& bg) : fg_ (**fg), bg_ (**bg) {};
 
         /**
          * Returns a Surface containing c rendered in font.
@@ -118,7 +136,7 @@ namespace ttf {
          * @return The rendered Surface.
          */
         Surface render (const Font& font, char c) const {
-            return TTF_RenderGlyph_Shaded (*font, c, **fg_, **bg_);
+            return TTF_RenderGlyph_Shaded (*font, c, fg_, bg_);
         };
 
         /**
@@ -133,37 +151,37 @@ namespace ttf {
          */
         template<int Encoding>
         Surface render (const Font& font, const string& text) const {
-            return Surface (TTF_RenderText_Shaded (*font, text.c_str (), **fg_, **bg_));
+            return Surface (TTF_RenderText_Shaded (*font, text.c_str (), fg_, bg_));
         };
 
         private:
             /**
              * The foreground Color.
              */
-            Color fg_;
+            SDL_Color fg_;
 
             /**
              * The background Color.
              */
-            Color bg_;
+            SDL_Color bg_;
     }; //Shaded
 
     //TEXT specialization
     template<>
     Surface Shaded::render<TEXT> (const Font& font, const string& text) const {
-        return Surface (TTF_RenderText_Shaded (*font, text.c_str (), **fg_, **bg_));
+        return Surface (TTF_RenderText_Shaded (*font, text.c_str (), fg_, bg_));
     };
 
     //UTF8 specialization
     template<>
     Surface Shaded::render<UTF8> (const Font& font, const string& text) const {
-        return Surface (TTF_RenderUTF8_Shaded (*font, text.c_str (), **fg_, **bg_));
+        return Surface (TTF_RenderUTF8_Shaded (*font, text.c_str (), fg_, bg_));
     };
 
     //UNICODE specialization
     template<>
     Surface Shaded::render<UNICODE> (const Font& font, const string& text) const {
-        return Surface ();//TTF_RenderUNICODE_Shaded (*font, text.c_str (), **fg_, **bg_));
+        return Surface ();//TTF_RenderUNICODE_Shaded (*font, text.c_str (), fg_, bg_));
     };
 
     /**
@@ -176,7 +194,14 @@ namespace ttf {
          *
          * @param color The color mask for the Font.
          */
-        Blended (const Color& color) : color_ (color) {};
+        Blended (SDL_Color color) : color_ (color) {};
+
+        /**
+         * Constructs a Blended font renderer with the specified color mask.
+         *
+         * @param color The color mask for the Font.
+         */
+        Blended (const Color& color) : color_ (**color) {};
 
         /**
          * Returns a Surface containing c rendered in font.
@@ -187,7 +212,7 @@ namespace ttf {
          * @return The rendered Surface.
          */
         Surface render (const Font& font, char c) const {
-            return Surface (TTF_RenderGlyph_Blended (*font, c, **color_));
+            return Surface (TTF_RenderGlyph_Blended (*font, c, color_));
         };
 
         /**
@@ -202,32 +227,312 @@ namespace ttf {
          */
         template<int Encoding>
         Surface render (const Font& font, const string& text) const {
-            return Surface (TTF_RenderText_Blended (*font, text.c_str (), **color_));
+            return Surface (TTF_RenderText_Blended (*font, text.c_str (), color_));
         };
 
         private:
             /**
              * The Color to render the Font.
              */
-            Color color_;
+            SDL_Color color_;
     }; //Blended
 
     //TEXT specialization
     template<>
     Surface Blended::render<TEXT> (const Font& font, const string& text) const {
-        return Surface (TTF_RenderText_Blended (*font, text.c_str (), **color_));
+        return Surface (TTF_RenderText_Blended (*font, text.c_str (), color_));
     };
 
     //UTF8 specialization
     template<>
     Surface Blended::render<UTF8> (const Font& font, const string& text) const {
-        return Surface (TTF_RenderUTF8_Blended (*font, text.c_str (), **color_));
+        return Surface (TTF_RenderUTF8_Blended (*font, text.c_str (), color_));
     };
 
     //UNICODE specialization
     template<>
     Surface Blended::render<UNICODE> (const Font& font, const string& text) const {
-        return Surface ();//TTF_RenderUNICODE_Blended (*font, text.c_str (), **color_));
+        return Surface ();//TTF_RenderUNICODE_Blended (*font, text.c_str (), color_));
+    };
+
+    /**
+     * @struct AlphaMask
+     * @brief Renders a font as an 8-bit coverage mask.
+     *
+     * The rendered Surface is palettized and each pixel value is the glyph
+     * coverage, 0 being transparent and 255 opaque. The color is applied when
+     * the mask is blitted, so a mask is a quarter the size of a Blended Surface
+     * and may be reused for any color.
+     */
+    struct AlphaMask {
+        /**
+         * Returns a Surface containing the coverage of c rendered in font.
+         *
+         * @param font The Font to use.
+         * @param c The character to render.
+         *
+         * @return The rendered Surface.
+         */
+        Surface render (const Font& font, char c) const {
+            return Surface (TTF_RenderGlyph_Shaded (*font, c, opaque (), transparent ()));
+        };
+
+        /**
+         * Returns a Surface containg the coverage of text rendered in font.
+         *
+         * @tparam Encoding The string encoding.
+         *
+         * @param font The font to use.
+         * @param text The string to render.
+         *
+         * @return The rendered Surface.
+         */
+        template<int Encoding>
+        Surface render (const Font& font, const string& text) const {
+            return Surface (TTF_RenderText_Shaded (*font, text.c_str (), opaque (), transparent ()));
+        };
+
+        /**
+         * Blits a mask onto dst, tinting it with color and compositing it over
+         * dst by coverage. Where dst has an alpha channel the result is the
+         * "over" composite, so masks may be drawn onto transparent Surfaces.
+         * Like SDL_BlitSurface, the blit is limited to the clip rectangle of dst.
+         *
+         * @param mask The mask, as rendered by an AlphaMask.
+         * @param color The Color with which to tint the mask.
+         * @param dst The Surface to blit to.
+         * @param x The left of the blit in dst.
+         * @param y The top of the blit in dst.
+         *
+         * @throws invalid_argument If mask is not an 8-bit Surface.
+         */
+        static void blit (const Surface& mask, SDL_Color color, Surface& dst, int x, int y) {
+            SDL_Surface* src = *mask;
+            SDL_Surface* out = *dst;
+            if (src == NULL || out == NULL)
+                return;
+            if (src->format->BytesPerPixel != 1)
+                throw invalid_argument ("AlphaMask::blit requires an 8-bit mask");
+
+            const SDL_Rect& bounds = out->clip_rect;
+            SDL_Rect clip;
+            clip.x = max (0, bounds.x - x);
+            clip.y = max (0, bounds.y - y);
+            int right = min (src->w, bounds.x + bounds.w - x);
+            int bottom = min (src->h, bounds.y + bounds.h - y);
+            if (clip.x >= right || clip.y >= bottom)
+                return;
+            clip.w = right - clip.x;
+            clip.h = bottom - clip.y;
+
+            if (SDL_MUSTLOCK (src) && SDL_LockSurface (src) == -1)
+                throw runtime_error (SDL_GetError ());
+            if (SDL_MUSTLOCK (out) && SDL_LockSurface (out) == -1) {
+                if (SDL_MUSTLOCK (src))
+                    SDL_UnlockSurface (src);
+                throw runtime_error (SDL_GetError ());
+            }
+
+            if (out->format->BytesPerPixel == 4)
+                blit32 (src, color, out, x, y, clip);
+            else
+                blitAny (src, color, out, x, y, clip);
+
+            if (SDL_MUSTLOCK (out))
+                SDL_UnlockSurface (out);
+            if (SDL_MUSTLOCK (src))
+                SDL_UnlockSurface (src);
+        };
+
+        private:
+            /**
+             * Returns the Color rendered for full coverage.
+             *
+             * @return The opaque Color.
+             */
+            static SDL_Color opaque () {
+                SDL_Color color = { 255, 255, 255, 0 };
+                return color;
+            };
+
+            /**
+             * Returns the Color rendered for no coverage.
+             *
+             * @return The transparent Color.
+             */
+            static SDL_Color transparent () {
+                SDL_Color color = { 0, 0, 0, 0 };
+                return color;
+            };
+
+            /**
+             * Composites a 32-bit dst, writing the packed channels directly.
+             *
+             * @param src The locked mask.
+             * @param color The tint Color.
+             * @param out The locked destination.
+             * @param x The left of the blit in out.
+             * @param y The top of the blit in out.
+             * @param clip The region of src to blit.
+             */
+            static void blit32 (SDL_Surface* src, SDL_Color color, SDL_Surface* out, int x, int y, const SDL_Rect& clip) {
+                const SDL_PixelFormat* format = out->format;
+                Uint32 solid = SDL_MapRGBA (out->format, color.r, color.g, color.b, 255);
+                for (int row = clip.y; row < clip.y + clip.h; ++row) {
+                    const Uint8* coverage = static_cast<const Uint8*> (src->pixels) + row * src->pitch;
+                    Uint32* pixel = reinterpret_cast<Uint32*> (pixelAt (out, 0, y + row));
+                    for (int col = clip.x; col < clip.x + clip.w; ++col) {
+                        Uint32 a = coverage[col];
+                        if (a == 0)
+                            continue;
+                        if (a == 255) {
+                            pixel[x + col] = solid;
+                            continue;
+                        }
+
+                        Uint32 p = pixel[x + col];
+                        Uint32 da = format->Amask ? (p & format->Amask) >> format->Ashift : 255;
+                        Uint32 keep = (da * (255 - a) + 127) / 255;
+                        Uint32 oa = a + keep;
+                        Uint32 value = over (color.r, (p & format->Rmask) >> format->Rshift, a, keep, oa) << format->Rshift
+                                     | over (color.g, (p & format->Gmask) >> format->Gshift, a, keep, oa) << format->Gshift
+                                     | over (color.b, (p & format->Bmask) >> format->Bshift, a, keep, oa) << format->Bshift;
+                        if (format->Amask)
+                            value |= oa << format->Ashift;
+                        pixel[x + col] = value;
+                    }
+                }
+            };
+
+            /**
+             * Composites a dst of any depth through SDL_GetRGBA and SDL_MapRGBA.
+             *
+             * @param src The locked mask.
+             * @param color The tint Color.
+             * @param out The locked destination.
+             * @param x The left of the blit in out.
+             * @param y The top of the blit in out.
+             * @param clip The region of src to blit.
+             */
+            static void blitAny (SDL_Surface* src, SDL_Color color, SDL_Surface* out, int x, int y, const SDL_Rect& clip) {
+                Uint32 solid = SDL_MapRGBA (out->format, color.r, color.g, color.b, 255);
+                for (int row = clip.y; row < clip.y + clip.h; ++row) {
+                    const Uint8* coverage = static_cast<const Uint8*> (src->pixels) + row * src->pitch;
+                    for (int col = clip.x; col < clip.x + clip.w; ++col) {
+                        Uint32 a = coverage[col];
+                        if (a == 0)
+                            continue;
+
+                        Uint8* pixel = pixelAt (out, x + col, y + row);
+                        if (a == 255) {
+                            putPixel (out, pixel, solid);
+                            continue;
+                        }
+
+                        Uint8 r, g, b, da;
+                        SDL_GetRGBA (getPixel (out, pixel), out->format, &r, &g, &b, &da);
+                        Uint32 keep = (da * (255 - a) + 127) / 255;
+                        Uint32 oa = a + keep;
+                        putPixel (out, pixel, SDL_MapRGBA (out->format,
+                                                           over (color.r, r, a, keep, oa),
+                                                           over (color.g, g, a, keep, oa),
+                                                           over (color.b, b, a, keep, oa),
+                                                           oa));
+                    }
+                }
+            };
+
+            /**
+             * Composites a source channel over a destination channel.
+             *
+             * @param src The source channel.
+             * @param dst The destination channel.
+             * @param alpha The source coverage, 0 to 255.
+             * @param keep The weight of the destination, its alpha scaled by 255 - alpha.
+             * @param result The resulting alpha, alpha + keep.
+             *
+             * @return The composited channel.
+             */
+            static Uint32 over (Uint32 src, Uint32 dst, Uint32 alpha, Uint32 keep, Uint32 result) {
+                return (src * alpha + dst * keep + result / 2) / result;
+            };
+
+            /**
+             * Returns the address of the pixel at x, y in surface.
+             *
+             * @param surface The Surface.
+             * @param x The column.
+             * @param y The row.
+             *
+             * @return The address of the pixel.
+             */
+            static Uint8* pixelAt (SDL_Surface* surface, int x, int y) {
+                return static_cast<Uint8*> (surface->pixels) + y * surface->pitch + x * surface->format->BytesPerPixel;
+            };
+
+            /**
+             * Reads a pixel of any depth.
+             *
+             * @param surface The Surface.
+             * @param pixel The address of the pixel.
+             *
+             * @return The pixel value.
+             */
+            static Uint32 getPixel (SDL_Surface* surface, const Uint8* pixel) {
+                switch (surface->format->BytesPerPixel) {
+                    case 1: return *pixel;
+                    case 2: return *reinterpret_cast<const Uint16*> (pixel);
+                    case 3:
+                        if (SDL_BYTEORDER == SDL_BIG_ENDIAN)
+                            return pixel[0] << 16 | pixel[1] << 8 | pixel[2];
+                        return pixel[0] | pixel[1] << 8 | pixel[2] << 16;
+                    default: return *reinterpret_cast<const Uint32*> (pixel);
+                }
+            };
+
+            /**
+             * Writes a pixel of any depth.
+             *
+             * @param surface The Surface.
+             * @param pixel The address of the pixel.
+             * @param value The pixel value.
+             */
+            static void putPixel (SDL_Surface* surface, Uint8* pixel, Uint32 value) {
+                switch (surface->format->BytesPerPixel) {
+                    case 1: *pixel = static_cast<Uint8> (value); break;
+                    case 2: *reinterpret_cast<Uint16*> (pixel) = static_cast<Uint16> (value); break;
+                    case 3:
+                        if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+                            pixel[0] = (value >> 16) & 0xff;
+                            pixel[1] = (value >> 8) & 0xff;
+                            pixel[2] = value & 0xff;
+                        } else {
+                            pixel[0] = value & 0xff;
+                            pixel[1] = (value >> 8) & 0xff;
+                            pixel[2] = (value >> 16) & 0xff;
+                        }
+                        break;
+                    default: *reinterpret_cast<Uint32*> (pixel) = value; break;
+                }
+            };
+    }; //AlphaMask
+
+    //TEXT specialization
+    template<>
+    Surface AlphaMask::render<TEXT> (const Font& font, const string& text) const {
+        return Surface (TTF_RenderText_Shaded (*font, text.c_str (), opaque (), transparent ()));
+    };
+
+    //UTF8 specialization
+    template<>
+    Surface AlphaMask::render<UTF8> (const Font& font, const string& text) const {
+        return Surface (TTF_RenderUTF8_Shaded (*font, text.c_str (), opaque (), transparent ()));
+    };
+
+    //UNICODE specialization
+    template<>
+    Surface AlphaMask::render<UNICODE> (const Font& font, const string& text) const {
+        return Surface ();//TTF_RenderUNICODE_Shaded (*font, text.c_str (), opaque (), transparent ()));
     };
 }; //ttf
 }; //sdl
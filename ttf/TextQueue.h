@@ -0,0 +1,244 @@
+/**
+ * @file TextQueue.h
+ * Contains the TextQueue class.
+ *
+ * Copyright (C) 2011 Thomas P. Lahoda
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef SDL_TTF_TEXTQUEUE_H
+#define SDL_TTF_TEXTQUEUE_H
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "sdlpp/video/Surface.h"
+#include "sdlpp_ttf/ttf/Font.h"
+
+namespace sdl {
+namespace ttf {
+    using namespace std;
+    using namespace video;
+
+    /**
+     * @struct TextQueue
+     * @brief Collects the text renders of a frame and renders each unique one once.
+     *
+     * Requests are submitted during the frame and resolved after flush. Identical
+     * requests share a single Surface. flush consumes the pending requests; the
+     * first submit after a flush starts a new frame and releases the previous
+     * frame's Surfaces, invalidating its Handles. Fonts are held by FontRef and
+     * must outlive the flush, and are rendered with their state, e.g. style,
+     * at flush time rather than at submit time.
+     *
+     * @tparam Encoding The string encoding.
+     * @tparam RenderMode The mode to use in rendering.
+     */
+    template<int Encoding, class RenderMode>
+    struct TextQueue {
+        /**
+         * @typedef size_t Handle
+         * @brief Identifies a submitted request.
+         */
+        typedef size_t Handle;
+
+        /**
+         * Constructs a TextQueue that renders in mode.
+         *
+         * @param mode The mode to use in rendering.
+         */
+        TextQueue (const RenderMode& mode) : mode_ (mode), requests_ (), slots_ (), surfaces_ (), flushed_ (false) {};
+
+        /**
+         * Submits text to be rendered in font. The first submit after a flush
+         * starts a new frame.
+         *
+         * @param font The Font to use.
+         * @param text The string to render.
+         *
+         * @return The Handle of the request.
+         */
+        Handle submit (const Font& font, const string& text) {
+            if (flushed_) {
+                slots_.clear ();
+                surfaces_.clear ();
+                flushed_ = false;
+            }
+            requests_.emplace_back (font, text);
+            return requests_.size () - 1;
+        };
+
+        /**
+         * A temporary Font may not be submitted, since it would not outlive the flush.
+         */
+        Handle submit (Font&&, const string&) = delete;
+
+        /**
+         * Renders every unique request submitted since the last flush, grouped
+         * by Font, and consumes the requests.
+         */
+        void flush () {
+            vector<Handle> order (requests_.size ());
+            for (Handle i = 0; i < order.size (); ++i)
+                order[i] = i;
+            sort (order.begin (), order.end (), Less (requests_));
+
+            slots_.assign (requests_.size (), 0);
+            surfaces_.clear ();
+            for (Handle i = 0; i < order.size (); ++i) {
+                const Request& request = requests_[order[i]];
+                if (i == 0 || Less::compare (requests_[order[i - 1]], request))
+                    surfaces_.push_back (mode_.template render<Encoding> (request.font.font (), request.text));
+                slots_[order[i]] = surfaces_.size () - 1;
+            }
+            requests_.clear ();
+            flushed_ = true;
+        };
+
+        /**
+         * Returns the Surface rendered for handle.
+         *
+         * @param handle The Handle returned by submit.
+         *
+         * @return The rendered Surface.
+         */
+        const Surface& surface (Handle handle) const {
+            if (handle >= slots_.size ())
+                throw out_of_range ("TextQueue handle has not been flushed");
+            return surfaces_[slots_[handle]];
+        };
+
+        /**
+         * Returns the number of Surfaces rendered by the last flush.
+         *
+         * @return The number of unique requests.
+         */
+        size_t unique () const { return surfaces_.size (); };
+
+        /**
+         * Discards all requests and Surfaces, ready for the next frame.
+         */
+        void clear () {
+            requests_.clear ();
+            slots_.clear ();
+            surfaces_.clear ();
+            flushed_ = false;
+        };
+
+        private:
+            /**
+             * @struct Request
+             * @brief A submitted render.
+             */
+            struct Request {
+                /**
+                 * Constructs a Request.
+                 *
+                 * @param f The Font to use.
+                 * @param t The string to render.
+                 */
+                Request (FontRef f, const string& t) : font (f), text (t) {};
+
+                /**
+                 * The Font to use.
+                 */
+                FontRef font;
+
+                /**
+                 * The string to render.
+                 */
+                string text;
+            }; //Request
+
+            /**
+             * @struct Less
+             * @brief Orders request indices by Font, then by text.
+             */
+            struct Less {
+                /**
+                 * Constructs a Less over requests.
+                 *
+                 * @param requests The requests being ordered.
+                 */
+                Less (const vector<Request>& requests) : requests_ (requests) {};
+
+                /**
+                 * Compares the requests at lhs and rhs.
+                 *
+                 * @param lhs The left index.
+                 * @param rhs The right index.
+                 *
+                 * @return True if lhs orders before rhs, false otherwise.
+                 */
+                bool operator() (Handle lhs, Handle rhs) const {
+                    return compare (requests_[lhs], requests_[rhs]);
+                };
+
+                /**
+                 * Compares two requests.
+                 *
+                 * @param lhs The left Request.
+                 * @param rhs The right Request.
+                 *
+                 * @return True if lhs orders before rhs, false otherwise.
+                 */
+                static bool compare (const Request& lhs, const Request& rhs) {
+                    less<TTF_Font*> fontLess;
+                    if (fontLess (*lhs.font, *rhs.font))
+                        return true;
+                    if (fontLess (*rhs.font, *lhs.font))
+                        return false;
+                    return lhs.text < rhs.text;
+                };
+
+                private:
+                    /**
+                     * The requests being ordered.
+                     */
+                    const vector<Request>& requests_;
+            }; //Less
+
+            /**
+             * The mode to use in rendering.
+             */
+            RenderMode mode_;
+
+            /**
+             * The submitted requests.
+             */
+            vector<Request> requests_;
+
+            /**
+             * The index into surfaces_ of each request.
+             */
+            vector<size_t> slots_;
+
+            /**
+             * The unique rendered Surfaces.
+             */
+            vector<Surface> surfaces_;
+
+            /**
+             * Whether the last call was a flush, so the next submit starts a new frame.
+             */
+            bool flushed_;
+    }; //TextQueue
+}; //ttf
+}; //sdl
+
+#endif //SDL_TTF_TEXTQUEUE_H